@@ -0,0 +1,140 @@
+/* SoapySDR module for Harogic Devices
+ *
+ * Copyright (C) 2025 Sébastien Dudek / penthertz.com
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * Or see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BURST_QUEUE_HPP
+#define BURST_QUEUE_HPP
+
+#include "PowerSquelch.hpp"
+
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+// Next read planned by BurstQueue::nextRead()
+struct BurstRead
+{
+    size_t count;      // Samples to take from the ring, 0 if nothing can be delivered yet
+    bool inBurst;      // Samples belong to a squelch burst
+    bool hasTime;      // First read of a burst, timeNs is valid
+    long long timeNs;
+};
+
+// Squelch burst boundaries for the samples held in the ring buffer.
+// Positions count samples written to / read from the ring since clear(); not thread-safe.
+class BurstQueue
+{
+    public:
+        BurstQueue() : _written(0), _read(0) {}
+
+        void clear() {
+            _markers.clear();
+            _written = 0;
+            _read = 0;
+        }
+
+        uint64_t writePosition() const { return _written; }
+        uint64_t readPosition() const { return _read; }
+        bool isOpen() const { return !_markers.empty() && _markers.back().end == OPEN; }
+
+        // Writer side: samples written to the ring outside of squelch
+        void appendUngated(size_t len) { _written += len; }
+
+        // Writer side: gated samples written to the ring, described by PowerSquelch segments
+        template <typename ToTimeNs>
+        void appendSegments(const std::vector<SquelchSegment> &segments, size_t len, ToTimeNs toTimeNs) {
+            for (const SquelchSegment &seg : segments) {
+                uint64_t segStart = _written + seg.offset;
+                if (seg.length > 0 && (seg.startsBurst || !isOpen())) {
+                    _close(segStart);
+                    _markers.push_back({segStart, OPEN, toTimeNs(seg.firstIndex)});
+                }
+                if (seg.endsBurst) _close(segStart + seg.length);
+            }
+            _written += len;
+        }
+
+        // Writer side: end the open burst at the current write position (drop, overflow, retune...)
+        void closeBurst() { _close(_written); }
+
+        // Reader side: nextRead() can deliver a full read, or a short one that ends at a burst boundary
+        bool ready(size_t available, size_t numElems) const {
+            if (_markers.empty()) return available >= numElems;
+            const Marker &burst = _markers.front();
+            if (burst.start == burst.end) return true;
+            if (_read < burst.start) return available > 0;
+            if (burst.end == OPEN) return available > numElems;
+            return available >= std::min<uint64_t>(numElems, burst.end - _read);
+        }
+
+        // Reader side: never let a read cross a burst boundary
+        BurstRead nextRead(size_t available, size_t numElems) {
+            BurstRead next = {0, false, false, 0};
+            // Empty bursts carry no samples and would otherwise block the queue
+            while (!_markers.empty() && _markers.front().start == _markers.front().end) _markers.pop_front();
+
+            if (_markers.empty()) {
+                next.count = (available >= numElems) ? numElems : 0;
+                return next;
+            }
+
+            const Marker &burst = _markers.front();
+            uint64_t count = std::min(numElems, available);
+            if (_read < burst.start) {
+                // Ungated samples queued before squelch was enabled
+                count = std::min<uint64_t>(count, burst.start - _read);
+            } else {
+                next.inBurst = true;
+                if (_read == burst.start) {
+                    next.hasTime = true;
+                    next.timeNs = burst.timeNs;
+                }
+                // Hold back the last sample of an open burst so END_BURST always has a read to ride on
+                if (burst.end != OPEN) count = std::min<uint64_t>(count, burst.end - _read);
+                else count = std::min<uint64_t>(count, (available > 0) ? available - 1 : 0);
+            }
+            next.count = count;
+            return next;
+        }
+
+        // Reader side: returns true when the read completed a burst
+        bool consume(size_t count) {
+            _read += count;
+            if (_markers.empty() || _markers.front().end == OPEN || _read < _markers.front().end) return false;
+            _markers.pop_front();
+            return true;
+        }
+
+    private:
+        struct Marker { uint64_t start; uint64_t end; long long timeNs; };
+        static constexpr uint64_t OPEN = UINT64_MAX;
+
+        void _close(uint64_t end) {
+            if (!isOpen()) return;
+            if (_markers.back().start >= end) _markers.pop_back();
+            else _markers.back().end = end;
+        }
+
+        std::deque<Marker> _markers;
+        uint64_t _written;
+        uint64_t _read;
+};
+
+#endif // BURST_QUEUE_HPP
@@ -35,7 +35,16 @@ SoapyHarogic::SoapyHarogic(const SoapySDR::Kwargs &args) :
     _if_agc(false),
     _lo_mode(LOOpt_Auto),
     _overflow_flag(false),
-    _native_format_selection("AUTO")
+    _native_format_selection("AUTO"),
+    _squelch_enabled(false),
+    _squelch_threshold(SQUELCH_DEFAULT_THRESHOLD),
+    _squelch_window(SQUELCH_DEFAULT_WINDOW),
+    _squelch_hang(SQUELCH_DEFAULT_HANG),
+    _squelch_pretrigger(SQUELCH_DEFAULT_PRETRIGGER),
+    _squelch_config_gen(0),
+    _squelch_bursts(0),
+    _squelch_samples_in(0),
+    _squelch_samples_out(0)
 {
     if (args.count("serial")) _serial = args.at("serial");
 
@@ -138,6 +147,7 @@ SoapySDR::Stream *SoapyHarogic::setupStream(const int direction, const std::stri
 void SoapyHarogic::closeStream(SoapySDR::Stream *stream) {
     this->deactivateStream(stream, 0, 0);
     _ring_buffer.clear();
+    _burst_queue.clear();
     _native_format_selection = "AUTO";
 }
 size_t SoapyHarogic::getStreamMTU(SoapySDR::Stream *) const { return _mtu; }
@@ -199,6 +209,7 @@ int SoapyHarogic::activateStream(SoapySDR::Stream *, const int, const long long,
         SoapySDR_logf(SOAPY_SDR_INFO, "  - IF AGC:           %s", _profile.EnableIFAGC ? "On" : "Off");
         std::string gainStratStr = (_profile.GainStrategy == LowNoisePreferred) ? "Low Noise" : "High Linearity";
         SoapySDR_logf(SOAPY_SDR_INFO, "  - Gain Strategy:    %s", gainStratStr.c_str());
+        if (_squelch_enabled) SoapySDR_logf(SOAPY_SDR_INFO, "  - Squelch:          %.1f dBFS", _squelch_threshold.load());
         SoapySDR_log(SOAPY_SDR_INFO, "---------------------------------------------");
 
         IQS_StreamInfo_TypeDef info;
@@ -211,6 +222,10 @@ int SoapyHarogic::activateStream(SoapySDR::Stream *, const int, const long long,
         ret = IQS_BusTriggerStart(&_dev_handle);
         if (ret < 0) throw std::runtime_error("IQS_BusTriggerStart failed with code " + std::to_string(ret));
         
+        _squelch_bursts = 0;
+        _squelch_samples_in = 0;
+        _squelch_samples_out = 0;
+
         _rx_thread_running = true;
         _rx_worker_thread = std::thread(&SoapyHarogic::_rx_thread, this);
         SoapySDR_logf(SOAPY_SDR_INFO, "Stream activated with MTU %zu", _mtu);
@@ -242,20 +257,28 @@ int SoapyHarogic::deactivateStream(SoapySDR::Stream *, const int, const long lon
     return 0;
 }
 
-int SoapyHarogic::readStream(SoapySDR::Stream *, void *const *buffs, const size_t numElems, int &flags, long long &, const long timeoutUs) {
+int SoapyHarogic::readStream(SoapySDR::Stream *, void *const *buffs, const size_t numElems, int &flags, long long &timeNs, const long timeoutUs) {
     std::unique_lock<std::mutex> lock(_buffer_mutex);
-    if (!_buffer_cv.wait_for(lock, std::chrono::microseconds(timeoutUs), [&]{ return _ring_buffer.size() >= numElems || !_rx_thread_running; })) {
+    if (!_buffer_cv.wait_for(lock, std::chrono::microseconds(timeoutUs), [&]{ return _burst_queue.ready(_ring_buffer.size(), numElems) || !_rx_thread_running; })) {
         return SOAPY_SDR_TIMEOUT;
     }
-    if (!_rx_thread_running && _ring_buffer.size() < numElems) {
-        return SOAPY_SDR_STREAM_ERROR;
-    }
+    BurstRead next = _burst_queue.nextRead(_ring_buffer.size(), numElems);
+    if (next.count == 0) return _rx_thread_running ? SOAPY_SDR_TIMEOUT : SOAPY_SDR_STREAM_ERROR;
+
+    // Inside a squelch burst END_BURST marks the burst end; overflows close the burst in the RX thread instead
     flags = 0;
-    if (_overflow_flag.exchange(false)) {
+    if (!next.inBurst && _overflow_flag.exchange(false)) {
         flags |= SOAPY_SDR_END_BURST;
         SoapySDR_log(SOAPY_SDR_SSI, "D");
     }
-    return _ring_buffer.read((std::complex<float>*)buffs[0], numElems);
+    if (next.hasTime) {
+        flags |= SOAPY_SDR_HAS_TIME;
+        timeNs = next.timeNs;
+    }
+
+    size_t ret = _ring_buffer.read((std::complex<float>*)buffs[0], next.count);
+    if (_burst_queue.consume(ret)) flags |= SOAPY_SDR_END_BURST;
+    return ret;
 }
 
 void SoapyHarogic::_rx_thread() {
@@ -264,6 +287,17 @@ void SoapyHarogic::_rx_thread() {
     if (_mtu > 0) temp_buf.resize(_mtu);
     IQStream_TypeDef iqs;
 
+    PowerSquelch squelch;
+    std::vector<std::complex<float>> gated_buf;
+    std::vector<SquelchSegment> segments;
+    bool squelch_active = false;
+    unsigned squelch_gen = 0;
+    uint64_t stream_index = 0;
+    // Burst times: ns elapsed up to the last sample rate change, plus ticks since then at the new rate
+    long long time_base_ns = 0;
+    uint64_t time_base_index = 0;
+    double time_base_rate = _sample_rate;
+
     while (_rx_thread_running) {
         int ret;
         {
@@ -276,7 +310,21 @@ void SoapyHarogic::_rx_thread() {
 
         if (ret < 0) {
             if (ret == APIRETVAL_WARNING_BusTimeOut) { SoapySDR_log(SOAPY_SDR_SSI, "T"); continue; }
-            if (ret == APIRETVAL_WARNING_IFOverflow) { _overflow_flag = true; continue; }
+            if (ret == APIRETVAL_WARNING_IFOverflow) {
+                // The packet is discarded but its samples still elapsed; keep burst timestamps aligned.
+                // iqs is not filled on a warning return, so assume the last good packet size.
+                stream_index += temp_buf.size();
+                if (squelch_active) {
+                    // End the current burst here; the next gated samples start a new timed burst.
+                    // Detector history from before the gap must not leak into that burst.
+                    squelch.reset();
+                    std::lock_guard<std::mutex> lock(_buffer_mutex);
+                    _burst_queue.closeBurst();
+                    SoapySDR_log(SOAPY_SDR_SSI, "D");
+                }
+                else _overflow_flag = true;
+                continue;
+            }
             
             SoapySDR_logf(SOAPY_SDR_ERROR, "Fatal streaming error: %d. Worker thread stopping.", ret);
             _rx_thread_running = false;
@@ -306,12 +354,60 @@ void SoapyHarogic::_rx_thread() {
                 break;
         }
 
+        uint64_t first_index = stream_index;
+        stream_index += packetSamples;
+        if (_sample_rate != time_base_rate) {
+            time_base_ns += SoapySDR::ticksToTimeNs(first_index - time_base_index, time_base_rate);
+            time_base_index = first_index;
+            time_base_rate = _sample_rate;
+        }
+
+        bool gate = _squelch_enabled;
+        unsigned gen = _squelch_config_gen;
+        bool restart = gate && (!squelch_active || gen != squelch_gen);
+        if (restart) {
+            squelch.configure(_squelch_threshold, _squelch_window, _squelch_hang, _squelch_pretrigger);
+            squelch_gen = gen;
+        }
+
+        if (!gate) {
+            std::unique_lock<std::mutex> lock(_buffer_mutex);
+            if (squelch_active) _burst_queue.closeBurst();
+            if (_ring_buffer.write(temp_buf.data(), packetSamples)) _burst_queue.appendUngated(packetSamples);
+            else SoapySDR_log(SOAPY_SDR_SSI, "O");
+            lock.unlock();
+            _buffer_cv.notify_one();
+            squelch_active = false;
+            continue;
+        }
+        squelch_active = true;
+
+        squelch.process(temp_buf.data(), packetSamples, first_index, gated_buf, segments);
+        _squelch_samples_in += packetSamples;
+
         std::unique_lock<std::mutex> lock(_buffer_mutex);
-        if (!_ring_buffer.write(temp_buf.data(), packetSamples)) SoapySDR_log(SOAPY_SDR_SSI, "O");
+        if (restart) _burst_queue.closeBurst();
+        if (_ring_buffer.write(gated_buf.data(), gated_buf.size())) {
+            for (const SquelchSegment &seg : segments) {
+                if (seg.startsBurst) ++_squelch_bursts;
+            }
+            _burst_queue.appendSegments(segments, gated_buf.size(), [&](uint64_t index) {
+                return time_base_ns + SoapySDR::ticksToTimeNs((long long)(index - time_base_index), time_base_rate);
+            });
+            _squelch_samples_out += gated_buf.size();
+        } else {
+            // Dropping the packet truncates the burst; a new one starts at the next accepted packet
+            SoapySDR_log(SOAPY_SDR_SSI, "O");
+            _burst_queue.closeBurst();
+        }
         lock.unlock();
         _buffer_cv.notify_one();
     }
 
+    {
+        std::lock_guard<std::mutex> lock(_buffer_mutex);
+        _burst_queue.closeBurst();
+    }
     _buffer_cv.notify_all();
     SoapySDR_log(SOAPY_SDR_INFO, "RX worker thread finished.");
 }
@@ -332,8 +428,70 @@ SoapySDR::ArgInfoList SoapyHarogic::getSettingInfo(void) const {
     lo_mode_arg.options = {"Auto", "Speed", "Spurs", "Phase Noise"};
     lo_mode_arg.value = "Auto";
     infos.push_back(lo_mode_arg);
+    SoapySDR::ArgInfo squelch_arg;
+    squelch_arg.key = "squelch";
+    squelch_arg.name = "Power Squelch";
+    squelch_arg.description = "Only deliver bursts whose windowed power exceeds squelch_threshold.";
+    squelch_arg.type = SoapySDR::ArgInfo::BOOL;
+    squelch_arg.value = _squelch_enabled ? "true" : "false";
+    infos.push_back(squelch_arg);
+    SoapySDR::ArgInfo squelch_threshold_arg;
+    squelch_threshold_arg.key = "squelch_threshold";
+    squelch_threshold_arg.name = "Squelch Threshold";
+    squelch_threshold_arg.description = "Mean power over the detection window that opens the squelch.";
+    squelch_threshold_arg.units = "dBFS";
+    squelch_threshold_arg.type = SoapySDR::ArgInfo::FLOAT;
+    squelch_threshold_arg.range = SoapySDR::Range(SQUELCH_MIN_THRESHOLD, SQUELCH_MAX_THRESHOLD);
+    squelch_threshold_arg.value = std::to_string(_squelch_threshold.load());
+    infos.push_back(squelch_threshold_arg);
+    SoapySDR::ArgInfo squelch_window_arg;
+    squelch_window_arg.key = "squelch_window";
+    squelch_window_arg.name = "Squelch Window";
+    squelch_window_arg.description = "Length of the sliding power estimation window.";
+    squelch_window_arg.units = "samples";
+    squelch_window_arg.type = SoapySDR::ArgInfo::INT;
+    squelch_window_arg.value = std::to_string(_squelch_window.load());
+    infos.push_back(squelch_window_arg);
+    SoapySDR::ArgInfo squelch_hang_arg;
+    squelch_hang_arg.key = "squelch_hang";
+    squelch_hang_arg.name = "Squelch Hang Time";
+    squelch_hang_arg.description = "Samples kept after the power drops below threshold before the burst ends.";
+    squelch_hang_arg.units = "samples";
+    squelch_hang_arg.type = SoapySDR::ArgInfo::INT;
+    squelch_hang_arg.value = std::to_string(_squelch_hang.load());
+    infos.push_back(squelch_hang_arg);
+    SoapySDR::ArgInfo squelch_pretrigger_arg;
+    squelch_pretrigger_arg.key = "squelch_pretrigger";
+    squelch_pretrigger_arg.name = "Squelch Pre-trigger";
+    squelch_pretrigger_arg.description = "History samples prepended to each burst.";
+    squelch_pretrigger_arg.units = "samples";
+    squelch_pretrigger_arg.type = SoapySDR::ArgInfo::INT;
+    squelch_pretrigger_arg.value = std::to_string(_squelch_pretrigger.load());
+    infos.push_back(squelch_pretrigger_arg);
+    SoapySDR::ArgInfo squelch_bursts_arg;
+    squelch_bursts_arg.key = "squelch_bursts";
+    squelch_bursts_arg.name = "Squelch Bursts";
+    squelch_bursts_arg.description = "Read-only: number of bursts detected since the stream was activated.";
+    squelch_bursts_arg.type = SoapySDR::ArgInfo::INT;
+    squelch_bursts_arg.value = readSetting("squelch_bursts");
+    infos.push_back(squelch_bursts_arg);
+    SoapySDR::ArgInfo squelch_duty_arg;
+    squelch_duty_arg.key = "squelch_duty_cycle";
+    squelch_duty_arg.name = "Squelch Duty Cycle";
+    squelch_duty_arg.description = "Read-only: fraction of received samples delivered since the stream was activated.";
+    squelch_duty_arg.type = SoapySDR::ArgInfo::FLOAT;
+    squelch_duty_arg.range = SoapySDR::Range(0.0, 1.0);
+    squelch_duty_arg.value = readSetting("squelch_duty_cycle");
+    infos.push_back(squelch_duty_arg);
     return infos;
 }
+// Parse a non-negative sample count for the squelch settings, clamped to maxValue
+static size_t parseSquelchSamples(const std::string &value, size_t maxValue) {
+    long long parsed = std::stoll(value);
+    if (parsed < 0) throw std::out_of_range("must not be negative");
+    return (size_t)std::min<unsigned long long>(parsed, maxValue);
+}
+
 void SoapyHarogic::writeSetting(const std::string &key, const std::string &value) {
     if (key == "gain_strategy") _gain_strategy = (value == "Low Noise") ? LowNoisePreferred : HighLinearityPreferred;
     else if (key == "lo_mode") {
@@ -342,6 +500,37 @@ void SoapyHarogic::writeSetting(const std::string &key, const std::string &value
         else if (value == "Phase Noise") _lo_mode = LOOpt_PhaseNoise;
         else _lo_mode = LOOpt_Auto;
     }
+    else if (key.compare(0, 7, "squelch") == 0) {
+        // Squelch runs in the RX thread; no device reconfiguration needed.
+        // Toggling is picked up there directly, other changes restart the detector.
+        bool changed = false;
+        try {
+            if (key == "squelch") _squelch_enabled = (value == "true" || value == "1");
+            else if (key == "squelch_threshold") {
+                double threshold = std::stod(value);
+                if (!std::isfinite(threshold)) throw std::invalid_argument("must be a finite number");
+                threshold = std::min(std::max(threshold, SQUELCH_MIN_THRESHOLD), SQUELCH_MAX_THRESHOLD);
+                changed = _squelch_threshold.exchange(threshold) != threshold;
+            }
+            else if (key == "squelch_window") {
+                size_t window = std::max<size_t>(parseSquelchSamples(value, SQUELCH_MAX_WINDOW), 1);
+                changed = _squelch_window.exchange(window) != window;
+            }
+            else if (key == "squelch_hang") {
+                size_t hang = parseSquelchSamples(value, SIZE_MAX);
+                changed = _squelch_hang.exchange(hang) != hang;
+            }
+            else if (key == "squelch_pretrigger") {
+                size_t pretrigger = parseSquelchSamples(value, SQUELCH_MAX_PRETRIGGER);
+                changed = _squelch_pretrigger.exchange(pretrigger) != pretrigger;
+            }
+        } catch (const std::exception &e) {
+            SoapySDR_logf(SOAPY_SDR_ERROR, "Invalid value '%s' for %s: %s", value.c_str(), key.c_str(), e.what());
+            return;
+        }
+        if (changed) ++_squelch_config_gen;
+        return;
+    }
     if (_rx_thread_running) _apply_settings();
 }
 std::string SoapyHarogic::readSetting(const std::string &key) const {
@@ -352,6 +541,16 @@ std::string SoapyHarogic::readSetting(const std::string &key) const {
         if (_lo_mode == LOOpt_PhaseNoise) return "Phase Noise";
         return "Auto";
     }
+    if (key == "squelch") return _squelch_enabled ? "true" : "false";
+    if (key == "squelch_threshold") return std::to_string(_squelch_threshold.load());
+    if (key == "squelch_window") return std::to_string(_squelch_window.load());
+    if (key == "squelch_hang") return std::to_string(_squelch_hang.load());
+    if (key == "squelch_pretrigger") return std::to_string(_squelch_pretrigger.load());
+    if (key == "squelch_bursts") return std::to_string(_squelch_bursts.load());
+    if (key == "squelch_duty_cycle") {
+        uint64_t in = _squelch_samples_in;
+        return std::to_string(in ? (double)_squelch_samples_out / in : 0.0);
+    }
     return "";
 }
 
@@ -433,6 +632,8 @@ void SoapyHarogic::_apply_settings() {
         return;
     }
     _mtu = info.PacketSamples;
+    // Samples from before the retune must not join a burst after it: close it and restart the squelch
+    ++_squelch_config_gen;
 
     ret = IQS_BusTriggerStart(&_dev_handle);
     if (ret < 0) {
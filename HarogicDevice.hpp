@@ -25,14 +25,19 @@
 #include <SoapySDR/Registry.hpp>
 #include <SoapySDR/Logger.h>
 #include <SoapySDR/Formats.hpp>
+#include <SoapySDR/Time.hpp>
 
 #include <htra_api.h>
 
+#include "PowerSquelch.hpp"
+#include "BurstQueue.hpp"
+
 #include <stdexcept>
 #include <iostream>
 #include <vector>
 #include <string>
 #include <map>
+#include <complex>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -41,6 +46,7 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cstring> // For memcpy
+#include <cmath>
 
 #define RESOLTRIG 62e6 // thresold for 8-bit resolution
 #define MIN_FREQ 9e3
@@ -202,6 +208,18 @@ class SoapyHarogic : public SoapySDR::Device
         std::map<std::string, RxPort_TypeDef> _rx_ports;
         std::atomic<bool> _overflow_flag;
         std::string _native_format_selection; // To store the user's format choice
+
+        // Power squelch settings (written by writeSetting, picked up by the RX thread)
+        std::atomic<bool> _squelch_enabled;
+        std::atomic<double> _squelch_threshold;
+        std::atomic<size_t> _squelch_window;
+        std::atomic<size_t> _squelch_hang;
+        std::atomic<size_t> _squelch_pretrigger;
+        std::atomic<unsigned> _squelch_config_gen;
+        std::atomic<uint64_t> _squelch_bursts;
+        std::atomic<uint64_t> _squelch_samples_in;
+        std::atomic<uint64_t> _squelch_samples_out;
+        BurstQueue _burst_queue; // Burst boundaries of the ring contents, guarded by _buffer_mutex
 };
 
 #endif // HAROGIC_DEVICE_HPP
\ No newline at end of file
@@ -0,0 +1,156 @@
+/* SoapySDR module for Harogic Devices
+ *
+ * Copyright (C) 2025 Sébastien Dudek / penthertz.com
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * Or see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef POWER_SQUELCH_HPP
+#define POWER_SQUELCH_HPP
+
+#include <vector>
+#include <complex>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+
+#define SQUELCH_DEFAULT_THRESHOLD -60.0 // dBFS
+#define SQUELCH_MIN_THRESHOLD -120.0 // dBFS
+#define SQUELCH_MAX_THRESHOLD 0.0 // dBFS
+#define SQUELCH_DEFAULT_WINDOW 64 // samples
+#define SQUELCH_DEFAULT_HANG 4096 // samples
+#define SQUELCH_DEFAULT_PRETRIGGER 1024 // samples
+#define SQUELCH_MAX_WINDOW (64 * 1024) // samples
+#define SQUELCH_MAX_PRETRIGGER (1024 * 1024) // samples, well below RING_BUFFER_SIZE
+
+// A contiguous run of gated samples produced by PowerSquelch::process()
+struct SquelchSegment
+{
+    size_t offset;        // Position of the first sample in the output buffer
+    size_t length;        // Number of samples in the run
+    uint64_t firstIndex;  // Stream index of the first sample, used for timestamps
+    bool startsBurst;     // Run begins with the pre-trigger history of a new burst
+    bool endsBurst;       // Run ends the burst (hang time expired); may be empty if it ends on in[0]
+};
+
+// Power squelch: sliding-window power detector with hang time and pre-trigger history
+class PowerSquelch
+{
+    public:
+        PowerSquelch() { configure(SQUELCH_DEFAULT_THRESHOLD, SQUELCH_DEFAULT_WINDOW, SQUELCH_DEFAULT_HANG, SQUELCH_DEFAULT_PRETRIGGER); }
+
+        void configure(double thresholdDb, size_t window, size_t hang, size_t pretrigger) {
+            _window.assign(std::max<size_t>(window, 1), 0.0f);
+            _thresholdSum = std::pow(10.0, thresholdDb / 10.0) * _window.size();
+            _hang = hang;
+            _pretrigger.assign(pretrigger, std::complex<float>(0.0f, 0.0f));
+            reset();
+        }
+
+        void reset() {
+            std::fill(_window.begin(), _window.end(), 0.0f);
+            _windowPos = 0;
+            _sum = 0.0;
+            _preCount = 0;
+            _prePos = 0;
+            _hangLeft = 0;
+            _open = false;
+        }
+
+        // Gate one packet; samples that pass are appended to out and described by segments
+        void process(const std::complex<float> *in, size_t len, uint64_t firstIndex,
+                     std::vector<std::complex<float>> &out, std::vector<SquelchSegment> &segments) {
+            out.clear();
+            segments.clear();
+
+            // Instantaneous power, written as a flat loop so the compiler can vectorize it
+            if (_power.size() < len) _power.resize(len);
+            const float *iq = reinterpret_cast<const float *>(in);
+            float *pw = _power.data();
+            for (size_t i = 0; i < len; ++i) pw[i] = iq[2*i] * iq[2*i] + iq[2*i+1] * iq[2*i+1];
+
+            const size_t windowLen = _window.size();
+            // If a burst is still open from the previous packet, it continues at in[0]
+            SquelchSegment seg = {0, 0, firstIndex, false, false};
+            size_t runStart = 0;
+
+            for (size_t i = 0; i < len; ++i) {
+                _sum += pw[i] - _window[_windowPos];
+                _window[_windowPos] = pw[i];
+                if (++_windowPos == windowLen) {
+                    // Re-sum once per window so rounding errors cannot accumulate
+                    _windowPos = 0;
+                    double exact = 0.0;
+                    for (float p : _window) exact += p;
+                    _sum = exact;
+                }
+                bool hot = _sum >= _thresholdSum;
+
+                if (_open) {
+                    if (hot) _hangLeft = _hang;
+                    else if (_hangLeft > 0) --_hangLeft;
+                    else {
+                        out.insert(out.end(), in + runStart, in + i);
+                        seg.length = out.size() - seg.offset;
+                        seg.endsBurst = true;
+                        segments.push_back(seg);
+                        _open = false;
+                        _push_pretrigger(in[i]);
+                    }
+                } else if (hot) {
+                    seg = {out.size(), 0, firstIndex + i - _preCount, true, false};
+                    for (size_t k = 0; k < _preCount; ++k) {
+                        out.push_back(_pretrigger[(_prePos + _pretrigger.size() - _preCount + k) % _pretrigger.size()]);
+                    }
+                    _preCount = 0;
+                    _prePos = 0;
+                    runStart = i;
+                    _hangLeft = _hang;
+                    _open = true;
+                } else {
+                    _push_pretrigger(in[i]);
+                }
+            }
+
+            if (_open) {
+                out.insert(out.end(), in + runStart, in + len);
+                seg.length = out.size() - seg.offset;
+                segments.push_back(seg);
+            }
+        }
+
+    private:
+        void _push_pretrigger(const std::complex<float> &sample) {
+            if (_pretrigger.empty()) return;
+            _pretrigger[_prePos] = sample;
+            if (++_prePos == _pretrigger.size()) _prePos = 0;
+            if (_preCount < _pretrigger.size()) ++_preCount;
+        }
+
+        std::vector<float> _power;
+        std::vector<float> _window;
+        size_t _windowPos;
+        double _sum;
+        double _thresholdSum;
+        size_t _hang;
+        size_t _hangLeft;
+        std::vector<std::complex<float>> _pretrigger;
+        size_t _prePos;
+        size_t _preCount;
+        bool _open;
+};
+
+#endif // POWER_SQUELCH_HPP
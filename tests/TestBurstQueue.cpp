@@ -0,0 +1,169 @@
+/* SoapySDR module for Harogic Devices
+ *
+ * Copyright (C) 2025 Sébastien Dudek / penthertz.com
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * Or see <https://www.gnu.org/licenses/>.
+ */
+
+// Host-side check of BurstQueue, no device or SoapySDR runtime needed
+
+#include "BurstQueue.hpp"
+
+#include <cstdio>
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); ++failures; } } while (0)
+
+struct Delivered { size_t count; bool inBurst; bool hasTime; long long timeNs; bool endBurst; };
+
+static long long toTimeNs(uint64_t index) { return (long long)index * 10; }
+
+static void append(BurstQueue &queue, const std::vector<SquelchSegment> &segments) {
+    size_t len = 0;
+    for (const SquelchSegment &seg : segments) len = std::max(len, seg.offset + seg.length);
+    queue.appendSegments(segments, len, toTimeNs);
+}
+
+// Read like readStream does until it would have to wait; the ring holds everything written but not read
+static std::vector<Delivered> drain(BurstQueue &queue, size_t numElems) {
+    std::vector<Delivered> reads;
+    for (;;) {
+        size_t available = queue.writePosition() - queue.readPosition();
+        if (!queue.ready(available, numElems)) break;
+        BurstRead next = queue.nextRead(available, numElems);
+        if (next.count == 0) break;
+        CHECK(next.count <= available && next.count <= numElems);
+        bool endBurst = queue.consume(next.count);
+        reads.push_back({next.count, next.inBurst, next.hasTime, next.timeNs, endBurst});
+    }
+    return reads;
+}
+
+static bool isRead(const Delivered &d, size_t count, bool inBurst, bool hasTime, long long timeNs, bool endBurst) {
+    return d.count == count && d.inBurst == inBurst && d.hasTime == hasTime && (!hasTime || d.timeNs == timeNs) && d.endBurst == endBurst;
+}
+
+int main() {
+    // Ungated samples queued before squelch was enabled are delivered before the burst, untimed
+    {
+        BurstQueue queue;
+        queue.appendUngated(100);
+        append(queue, {{0, 50, 1000, true, false}});
+        std::vector<Delivered> reads = drain(queue, 1000);
+        CHECK(reads.size() == 1);
+        if (reads.size() == 1) CHECK(isRead(reads[0], 100, false, false, 0, false));
+        // The open burst keeps its last sample back so END_BURST has a read to ride on
+        reads = drain(queue, 10);
+        CHECK(reads.size() == 4);
+        if (reads.size() == 4) {
+            CHECK(isRead(reads[0], 10, true, true, 10000, false));
+            CHECK(isRead(reads[3], 10, true, false, 0, false));
+        }
+        // Hang time expiring on the first sample of the next packet: empty closing segment
+        append(queue, {{0, 0, 1050, false, true}});
+        reads = drain(queue, 10);
+        CHECK(reads.size() == 1);
+        if (reads.size() == 1) CHECK(isRead(reads[0], 10, true, false, 0, true));
+    }
+
+    // Reader caught up with an open burst, then the burst is closed without new samples
+    {
+        BurstQueue queue;
+        append(queue, {{0, 10, 0, true, false}});
+        CHECK(drain(queue, 10).empty());
+        std::vector<Delivered> reads = drain(queue, 9);
+        CHECK(reads.size() == 1);
+        if (reads.size() == 1) CHECK(isRead(reads[0], 9, true, true, 0, false));
+        CHECK(!queue.ready(1, 1));
+        queue.closeBurst();
+        reads = drain(queue, 9);
+        CHECK(reads.size() == 1);
+        if (reads.size() == 1) CHECK(isRead(reads[0], 1, true, false, 0, true));
+        CHECK(!queue.isOpen());
+    }
+
+    // Ring drop in the middle of a burst: the rest of it becomes a new burst with its own time
+    {
+        BurstQueue queue;
+        append(queue, {{0, 25, 0, true, false}});
+        queue.closeBurst();
+        append(queue, {{0, 100, 300, false, false}});
+        append(queue, {{0, 20, 400, false, true}});
+        std::vector<Delivered> reads = drain(queue, 10);
+        CHECK(reads.size() == 3 + 12);
+        if (reads.size() == 15) {
+            CHECK(isRead(reads[0], 10, true, true, 0, false));
+            CHECK(isRead(reads[2], 5, true, false, 0, true));
+            CHECK(isRead(reads[3], 10, true, true, 3000, false));
+            CHECK(isRead(reads[14], 10, true, false, 0, true));
+        }
+    }
+
+    // IF overflow closes the burst and resets the detector: next burst starts fresh
+    {
+        BurstQueue queue;
+        append(queue, {{0, 50, 0, true, false}});
+        queue.closeBurst();
+        append(queue, {{0, 60, 200, true, true}});
+        std::vector<Delivered> reads = drain(queue, 1000);
+        CHECK(reads.size() == 2);
+        if (reads.size() == 2) {
+            CHECK(isRead(reads[0], 50, true, true, 0, true));
+            CHECK(isRead(reads[1], 60, true, true, 2000, true));
+        }
+    }
+
+    // An empty closing segment after a drop must not leave an empty marker behind
+    {
+        BurstQueue queue;
+        append(queue, {{0, 30, 0, true, false}});
+        queue.closeBurst();
+        queue.closeBurst();
+        append(queue, {{0, 0, 500, false, true}});
+        CHECK(!queue.isOpen());
+        std::vector<Delivered> reads = drain(queue, 100);
+        CHECK(reads.size() == 1);
+        if (reads.size() == 1) CHECK(isRead(reads[0], 30, true, true, 0, true));
+        // Squelch disabled afterwards: plain full-size reads
+        queue.appendUngated(100);
+        reads = drain(queue, 50);
+        CHECK(reads.size() == 2);
+        if (reads.size() == 2) CHECK(isRead(reads[1], 50, false, false, 0, false));
+    }
+
+    // Several bursts in one packet, each delivered separately
+    {
+        BurstQueue queue;
+        append(queue, {{0, 5, 10, true, true}, {5, 7, 40, true, true}, {12, 3, 90, true, false}});
+        std::vector<Delivered> reads = drain(queue, 100);
+        CHECK(reads.size() == 2);
+        if (reads.size() == 2) {
+            CHECK(isRead(reads[0], 5, true, true, 100, true));
+            CHECK(isRead(reads[1], 7, true, true, 400, true));
+        }
+        reads = drain(queue, 2);
+        CHECK(reads.size() == 1);
+        if (reads.size() == 1) CHECK(isRead(reads[0], 2, true, true, 900, false));
+    }
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("BurstQueue: all checks passed\n");
+    return 0;
+}
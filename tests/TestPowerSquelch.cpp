@@ -0,0 +1,151 @@
+/* SoapySDR module for Harogic Devices
+ *
+ * Copyright (C) 2025 Sébastien Dudek / penthertz.com
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * Or see <https://www.gnu.org/licenses/>.
+ */
+
+// Host-side check of PowerSquelch, no device or SoapySDR runtime needed
+
+#include "PowerSquelch.hpp"
+
+#include <cstdio>
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); ++failures; } } while (0)
+
+struct Burst { uint64_t first; uint64_t end; };
+
+// Noise floor at -60 dBFS, with full-scale tones at the given sample ranges.
+// The imaginary part encodes the sample index so delivered samples can be traced back.
+static std::vector<std::complex<float>> makeStream(size_t len, const std::vector<Burst> &tones) {
+    std::vector<std::complex<float>> stream(len);
+    for (size_t i = 0; i < len; ++i) stream[i] = std::complex<float>(0.001f, 0.0f);
+    for (const Burst &t : tones) {
+        for (uint64_t i = t.first; i < t.end; ++i) stream[i] = std::complex<float>(0.5f, 0.0f);
+    }
+    for (size_t i = 0; i < len; ++i) stream[i].imag(i * 1e-9f);
+    return stream;
+}
+
+// Feed the stream in packets, check every segment against the input and rebuild the bursts
+static std::vector<Burst> runSquelch(PowerSquelch &squelch, const std::vector<std::complex<float>> &stream, size_t packetLen,
+                                     std::vector<SquelchSegment> *allSegments = nullptr) {
+    std::vector<Burst> bursts;
+    std::vector<std::complex<float>> out;
+    std::vector<SquelchSegment> segments;
+    bool open = false;
+    for (size_t first = 0; first < stream.size(); first += packetLen) {
+        size_t len = std::min(packetLen, stream.size() - first);
+        squelch.process(stream.data() + first, len, first, out, segments);
+        size_t expectedOffset = 0;
+        for (const SquelchSegment &seg : segments) {
+            if (allSegments) allSegments->push_back(seg);
+            CHECK(seg.offset == expectedOffset);
+            CHECK(seg.offset + seg.length <= out.size());
+            for (size_t k = 0; k < seg.length; ++k) CHECK(out[seg.offset + k] == stream[seg.firstIndex + k]);
+            if (seg.startsBurst) {
+                CHECK(!open);
+                bursts.push_back({seg.firstIndex, seg.firstIndex});
+                open = true;
+            } else {
+                // A continued burst always resumes at the start of the packet
+                CHECK(open);
+                CHECK(seg.firstIndex == first);
+                CHECK(seg.firstIndex == bursts.back().end);
+            }
+            bursts.back().end = seg.firstIndex + seg.length;
+            if (seg.endsBurst) open = false;
+            expectedOffset = seg.offset + seg.length;
+        }
+        CHECK(expectedOffset == out.size());
+    }
+    return bursts;
+}
+
+int main() {
+    // Threshold -30 dBFS over 16 samples: one full-scale sample in the window is enough to open
+    PowerSquelch squelch;
+
+    // Burst inside a single packet: 50 pre-trigger samples, then 15 window + 100 hang samples of tail
+    squelch.configure(-30.0, 16, 100, 50);
+    std::vector<Burst> bursts = runSquelch(squelch, makeStream(3000, {{300, 400}}), 1000);
+    CHECK(bursts.size() == 1);
+    if (bursts.size() == 1) {
+        CHECK(bursts[0].first == 250);
+        CHECK(bursts[0].end == 515);
+    }
+
+    // Burst spanning a packet boundary, with pre-trigger history taken from the previous packet
+    squelch.configure(-30.0, 16, 100, 50);
+    bursts = runSquelch(squelch, makeStream(3000, {{1010, 1020}, {1980, 2020}}), 1000);
+    CHECK(bursts.size() == 2);
+    if (bursts.size() == 2) {
+        CHECK(bursts[0].first == 960);
+        CHECK(bursts[0].end == 1135);
+        CHECK(bursts[1].first == 1930);
+        CHECK(bursts[1].end == 2135);
+    }
+
+    // Packet size not aligned with the window length
+    squelch.configure(-30.0, 16, 100, 50);
+    bursts = runSquelch(squelch, makeStream(3000, {{1010, 1020}, {1980, 2020}}), 37);
+    CHECK(bursts.size() == 2);
+
+    // Hang time expiring on the first sample of a packet yields an empty closing segment
+    squelch.configure(-30.0, 1, 0, 0);
+    std::vector<SquelchSegment> segments;
+    bursts = runSquelch(squelch, makeStream(20, {{9, 10}}), 10, &segments);
+    CHECK(bursts.size() == 1);
+    CHECK(segments.size() == 2);
+    if (segments.size() == 2) {
+        CHECK(segments[0].startsBurst && !segments[0].endsBurst);
+        CHECK(segments[0].firstIndex == 9 && segments[0].length == 1);
+        CHECK(!segments[1].startsBurst && segments[1].endsBurst);
+        CHECK(segments[1].offset == 0 && segments[1].length == 0);
+    }
+
+    // A dropped packet resets the detector: no history or open gate carries across the gap
+    squelch.configure(-30.0, 16, 100, 50);
+    std::vector<std::complex<float>> stream = makeStream(3000, {{950, 1000}, {2010, 2020}});
+    std::vector<std::complex<float>> out;
+    segments.clear();
+    squelch.process(stream.data(), 1000, 0, out, segments);
+    CHECK(segments.size() == 1 && segments[0].startsBurst && !segments[0].endsBurst);
+    squelch.reset();
+    squelch.process(stream.data() + 2000, 1000, 2000, out, segments);
+    CHECK(segments.size() == 1);
+    if (segments.size() == 1) {
+        CHECK(segments[0].startsBurst && segments[0].endsBurst);
+        CHECK(segments[0].offset == 0);
+        CHECK(segments[0].firstIndex == 2000);
+        CHECK(segments[0].length == 135);
+        for (size_t k = 0; k < segments[0].length; ++k) CHECK(out[k] == stream[2000 + k]);
+    }
+
+    // Pure noise never opens the squelch
+    squelch.configure(-30.0, 16, 100, 50);
+    bursts = runSquelch(squelch, makeStream(3000, {}), 1000);
+    CHECK(bursts.empty());
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("PowerSquelch: all checks passed\n");
+    return 0;
+}